@@ -400,6 +400,8 @@ private:
 
 class timer;
 class releaser;
+template<typename T>
+class recycler;
 
 /// An interface for the task class
 class itask : public std::enable_shared_from_this<itask> {
@@ -474,6 +476,8 @@ private:
     friend struct transwarp::detail::parent_visitor;
     friend class transwarp::timer;
     friend class transwarp::releaser;
+    template<typename T>
+    friend class transwarp::recycler;
     friend struct transwarp::detail::decrement_refcount_functor;
 
     virtual void visit(const std::function<void(itask&)>& visitor) = 0;
@@ -1275,6 +1279,19 @@ struct final_visitor {
     std::size_t id_ = 0;
 };
 
+/// Sorts the given tasks by level and id which yields a valid execution order
+inline
+void sort_by_level(std::vector<transwarp::itask*>& tasks) {
+    auto compare = [](const transwarp::itask* const l, const transwarp::itask* const r) {
+        const std::size_t l_level = l->level();
+        const std::size_t l_id = l->id();
+        const std::size_t r_level = r->level();
+        const std::size_t r_id = r->id();
+        return std::tie(l_level, l_id) < std::tie(r_level, r_id);
+    };
+    std::sort(tasks.begin(), tasks.end(), compare);
+}
+
 /// Generates edges
 struct edges_visitor {
     explicit edges_visitor(std::vector<transwarp::edge>& edges) noexcept
@@ -1958,6 +1975,696 @@ private:
 };
 
 
+/// Detail namespace for internal functionality only
+namespace detail {
+
+/// Returns whether a task of the given type only needs one of its parents to finish
+inline
+bool needs_any_parent(transwarp::task_type type) noexcept {
+    return type == transwarp::task_type::accept_any ||
+           type == transwarp::task_type::consume_any ||
+           type == transwarp::task_type::wait_any;
+}
+
+/// Base class for executors that hold a task back until its parents have finished
+/// and the task is admitted. The task is then passed on to dispatch(). This way a
+/// dispatched task never blocks a worker while waiting for its parents.
+/// Only parents that pass through the same executor are waited for, all other
+/// parents are considered finished
+class gated_executor : public transwarp::executor {
+public:
+
+    ~gated_executor() {
+        wait_for_dispatched();
+    }
+
+    /// Holds the task back until its parents have finished and admit() is true
+    void execute(const std::function<void()>& functor, transwarp::itask& task) override {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            std::shared_ptr<entry> e = std::make_shared<entry>(functor, task);
+            std::size_t unfinished = 0;
+            bool finished_parent = false;
+            for (transwarp::itask* parent : task.parents()) {
+                const auto node_it = nodes_.find(parent);
+                if (node_it != nodes_.end()) {
+                    node_it->second.push_back(e);
+                    ++unfinished;
+                } else {
+                    finished_parent = true;
+                }
+            }
+            if (transwarp::detail::needs_any_parent(task.type())) {
+                e->wait_count = finished_parent || unfinished == 0 ? 0 : 1;
+            } else {
+                e->wait_count = unfinished;
+            }
+            nodes_[&task];
+            if (e->wait_count == 0) {
+                make_ready(e);
+            }
+        }
+        dispatch_ready();
+    }
+
+protected:
+
+    /// A task held back by the executor
+    struct entry {
+        entry(const std::function<void()>& f, transwarp::itask& t)
+        : functor(f), task(t)
+        {}
+        std::function<void()> functor;
+        transwarp::itask& task;
+        std::size_t wait_count = 0;
+    };
+
+    gated_executor() = default;
+
+    /// Whether the given ready task may be dispatched now (called with mutex_ locked)
+    virtual bool admit(transwarp::itask&) {
+        return true;
+    }
+
+    /// Called after the given task has finished running (called with mutex_ locked)
+    virtual void finished(transwarp::itask&) {}
+
+    /// The rank of a ready task. Tasks of higher rank are admitted first (called with mutex_ locked)
+    virtual std::int64_t rank(transwarp::itask&) {
+        return 0;
+    }
+
+    /// Runs the functor of an admitted task (called without a lock)
+    virtual void dispatch(const std::function<void()>& functor, transwarp::itask& task) = 0;
+
+    /// Dispatches all ready tasks that are admitted. Needs to be called by
+    /// subclasses when a change of state may admit further tasks
+    void dispatch_ready() {
+        std::vector<std::shared_ptr<entry>> released;
+        dispatch_ready(released);
+    }
+
+    /// Waits for dispatched tasks to leave the executor. Subclasses call this from
+    /// their destructor because the hooks may still be called until then
+    void wait_for_dispatched() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        cond_var_.wait(lock, [this]{ return in_flight_ == 0; });
+    }
+
+    /// Returns the number of dispatched tasks that haven't finished yet (call with mutex_ locked)
+    std::size_t running() const noexcept {
+        return running_;
+    }
+
+    std::mutex mutex_;
+
+private:
+
+    /// Dispatches admitted tasks. Their entries are appended to released to be
+    /// destroyed by the caller. Destroying an entry destroys the task's functor
+    /// which may hold the last reference to this executor
+    void dispatch_ready(std::vector<std::shared_ptr<entry>>& released) {
+        const std::size_t first = released.size();
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            for (auto ready_it = ready_.begin(); ready_it != ready_.end();) {
+                if (admit(ready_it->second->task)) {
+                    released.push_back(std::move(ready_it->second));
+                    ready_it = ready_.erase(ready_it);
+                    ++running_;
+                    ++in_flight_;
+                } else {
+                    ++ready_it;
+                }
+            }
+        }
+        for (std::size_t i = first; i < released.size(); ++i) {
+            const std::shared_ptr<entry> e = released[i];
+            dispatch([this, e]{
+                e->functor();
+                const std::vector<std::shared_ptr<entry>> finished_entries = finish(e->task);
+                std::lock_guard<std::mutex> lock{mutex_};
+                --in_flight_;
+                cond_var_.notify_all();
+            }, e->task);
+        }
+    }
+
+    std::vector<std::shared_ptr<entry>> finish(transwarp::itask& task) {
+        std::vector<std::shared_ptr<entry>> released;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            const auto node_it = nodes_.find(&task);
+            if (node_it != nodes_.end()) {
+                released = std::move(node_it->second);
+                nodes_.erase(node_it);
+                for (const std::shared_ptr<entry>& e : released) {
+                    if (e->wait_count > 0 && --e->wait_count == 0) {
+                        make_ready(e);
+                    }
+                }
+            }
+            --running_;
+            finished(task);
+        }
+        dispatch_ready(released);
+        return released;
+    }
+
+    void make_ready(const std::shared_ptr<entry>& e) {
+        ready_.emplace(rank(e->task), e);
+    }
+
+    std::unordered_map<const transwarp::itask*, std::vector<std::shared_ptr<entry>>> nodes_; // unfinished tasks and their waiting children
+    std::multimap<std::int64_t, std::shared_ptr<entry>, std::greater<std::int64_t>> ready_;
+    std::size_t running_ = 0;
+    std::size_t in_flight_ = 0; // dispatched tasks that haven't left the executor yet
+    std::condition_variable cond_var_;
+};
+
+} // detail
+
+
+/// Executor that bounds the memory held by live intermediate results. Tasks declare
+/// or report an estimated result size via set_result_size(). A task with a non-zero
+/// size is only started if the live results plus its own size fit into the budget
+/// or if nothing else is running. A task's result is considered live from the moment
+/// the task starts until its `after_satisfied` event, i.e. until all children have
+/// received the result. Ready tasks that consume live results are preferred.
+/// Tasks are handed to the given executor once their parents have finished so that
+/// held back tasks never block workers. The given executor must outlive the
+/// memory_budget. The memory_budget must be added as a listener to the tasks it
+/// schedules, e.g.:
+/// ```
+/// tw::parallel exec{4};
+/// auto budget = std::make_shared<tw::memory_budget>(exec, 1 << 30);
+/// task->add_listener_all(budget);
+/// task->schedule_all(*budget);
+/// ```
+class memory_budget : public transwarp::detail::gated_executor, public transwarp::listener {
+public:
+
+    /// Constructs a memory budget of the given bytes using the executor to run tasks
+    memory_budget(transwarp::executor& executor, std::size_t budget_bytes)
+    : executor_(executor),
+      budget_(budget_bytes)
+    {}
+
+    ~memory_budget() {
+        wait_for_dispatched();
+    }
+
+    // delete copy/move semantics
+    memory_budget(const memory_budget&) = delete;
+    memory_budget& operator=(const memory_budget&) = delete;
+    memory_budget(memory_budget&&) = delete;
+    memory_budget& operator=(memory_budget&&) = delete;
+
+    /// Returns the name of the executor
+    std::string name() const override {
+        return "transwarp::memory_budget";
+    }
+
+    /// Declares the estimated result size of the given task in bytes. This may also be
+    /// called while the task is running, e.g. from within the functor, to report the actual size
+    void set_result_size(const transwarp::itask& task, std::size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            sizes_[&task] = bytes;
+            const auto live_it = live_tasks_.find(&task);
+            if (live_it != live_tasks_.end()) {
+                live_ = live_ - live_it->second + bytes;
+                live_it->second = bytes;
+            }
+        }
+        dispatch_ready();
+    }
+
+    /// Returns the budget in bytes
+    std::size_t budget() const noexcept {
+        return budget_;
+    }
+
+    /// Returns the bytes held by live results
+    std::size_t live_bytes() {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return live_;
+    }
+
+    /// Releases a task's result from the budget once all children have received it
+    void handle_event(const transwarp::event_type event, transwarp::itask& task) override {
+        if (event == transwarp::event_type::after_satisfied) {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                release(task);
+            }
+            dispatch_ready();
+        }
+    }
+
+private:
+
+    bool admit(transwarp::itask& task) override {
+        const std::size_t size = result_size(task);
+        if (size > 0 && live_ + size > budget_ && running() > 0) {
+            return false;
+        }
+        release(task); // the result of a previous run is replaced
+        if (size > 0) {
+            live_tasks_[&task] = size;
+            live_ += size;
+        }
+        return true;
+    }
+
+    std::int64_t rank(transwarp::itask& task) override {
+        std::size_t unlocked = 0;
+        for (const transwarp::itask* parent : task.parents()) {
+            const auto live_it = live_tasks_.find(parent);
+            if (live_it != live_tasks_.end()) {
+                unlocked += live_it->second;
+            }
+        }
+        return static_cast<std::int64_t>(unlocked);
+    }
+
+    void dispatch(const std::function<void()>& functor, transwarp::itask& task) override {
+        executor_.execute(functor, task);
+    }
+
+    void release(const transwarp::itask& task) {
+        const auto live_it = live_tasks_.find(&task);
+        if (live_it != live_tasks_.end()) {
+            live_ -= live_it->second;
+            live_tasks_.erase(live_it);
+        }
+    }
+
+    std::size_t result_size(const transwarp::itask& task) const {
+        const auto size_it = sizes_.find(&task);
+        return size_it != sizes_.end() ? size_it->second : 0;
+    }
+
+    transwarp::executor& executor_;
+    const std::size_t budget_;
+    std::size_t live_ = 0;
+    std::unordered_map<const transwarp::itask*, std::size_t> sizes_;
+    std::unordered_map<const transwarp::itask*, std::size_t> live_tasks_;
+};
+
+
+/// Executor that runs tasks requiring scarce resources, e.g. a bounded number of
+/// database connections or exclusive access to a buffer. Each resource has a number
+/// of tokens. A ready task is held back until all tokens it requires are available
+/// and acquires them all at once so that tasks never hold some tokens while waiting
+/// for others. The tokens are returned when the task finishes. Tasks are handed to
+/// the given executor once their parents have finished and their tokens were
+/// acquired so no worker is blocked. The given executor must outlive the resource_limiter
+class resource_limiter : public transwarp::detail::gated_executor {
+public:
+
+    /// Constructs a resource limiter using the executor to run tasks
+    explicit resource_limiter(transwarp::executor& executor)
+    : executor_(executor)
+    {}
+
+    ~resource_limiter() {
+        wait_for_dispatched();
+    }
+
+    // delete copy/move semantics
+    resource_limiter(const resource_limiter&) = delete;
+    resource_limiter& operator=(const resource_limiter&) = delete;
+    resource_limiter(resource_limiter&&) = delete;
+    resource_limiter& operator=(resource_limiter&&) = delete;
+
+    /// Returns the name of the executor
+    std::string name() const override {
+        return "transwarp::resource_limiter";
+    }
+
+    /// Adds a resource with the given number of tokens and returns its id
+    std::size_t add_resource(std::string name, std::size_t tokens) {
+        if (tokens == 0) {
+            throw transwarp::invalid_parameter{"resource tokens"};
+        }
+        std::lock_guard<std::mutex> lock{mutex_};
+        resources_.push_back({std::move(name), tokens, tokens});
+        return resources_.size() - 1;
+    }
+
+    /// Declares that the task requires the given tokens of the resource while running.
+    /// Passing zero tokens removes the requirement
+    void require(const transwarp::itask& task, std::size_t resource_id, std::size_t tokens) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            const resource& r = get_resource(resource_id);
+            if (tokens > r.capacity) {
+                throw transwarp::invalid_parameter{"tokens exceed capacity of resource: " + r.name};
+            }
+            std::vector<requirement>& reqs = requirements_[&task];
+            const auto req_it = std::find_if(reqs.begin(), reqs.end(), [resource_id](const requirement& req) {
+                return req.resource_id == resource_id;
+            });
+            if (req_it != reqs.end()) {
+                reqs.erase(req_it);
+            }
+            if (tokens > 0) {
+                reqs.push_back({resource_id, tokens});
+            }
+        }
+        dispatch_ready();
+    }
+
+    /// Returns the name of the resource
+    std::string resource_name(std::size_t resource_id) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return get_resource(resource_id).name;
+    }
+
+    /// Returns the number of tokens of the resource
+    std::size_t capacity(std::size_t resource_id) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return get_resource(resource_id).capacity;
+    }
+
+    /// Returns the number of tokens of the resource that are currently available
+    std::size_t available(std::size_t resource_id) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return get_resource(resource_id).available;
+    }
+
+private:
+
+    struct resource {
+        std::string name;
+        std::size_t capacity;
+        std::size_t available;
+    };
+
+    struct requirement {
+        std::size_t resource_id;
+        std::size_t tokens;
+    };
+
+    bool admit(transwarp::itask& task) override {
+        const auto reqs_it = requirements_.find(&task);
+        if (reqs_it == requirements_.end() || reqs_it->second.empty()) {
+            return true;
+        }
+        for (const requirement& req : reqs_it->second) {
+            if (resources_[req.resource_id].available < req.tokens) {
+                return false;
+            }
+        }
+        for (const requirement& req : reqs_it->second) {
+            resources_[req.resource_id].available -= req.tokens;
+        }
+        held_[&task] = reqs_it->second;
+        return true;
+    }
+
+    void finished(transwarp::itask& task) override {
+        const auto held_it = held_.find(&task);
+        if (held_it != held_.end()) {
+            for (const requirement& req : held_it->second) {
+                resources_[req.resource_id].available += req.tokens;
+            }
+            held_.erase(held_it);
+        }
+    }
+
+    void dispatch(const std::function<void()>& functor, transwarp::itask& task) override {
+        executor_.execute(functor, task);
+    }
+
+    const resource& get_resource(std::size_t resource_id) const {
+        if (resource_id >= resources_.size()) {
+            throw transwarp::invalid_parameter{"resource id: " + std::to_string(resource_id)};
+        }
+        return resources_[resource_id];
+    }
+
+    transwarp::executor& executor_;
+    std::vector<resource> resources_;
+    std::unordered_map<const transwarp::itask*, std::vector<requirement>> requirements_;
+    std::unordered_map<const transwarp::itask*, std::vector<requirement>> held_; // tokens held by running tasks
+};
+
+
+namespace detail {
+template<typename Functor>
+class hedged_functor;
+} // detail
+
+/// Runtime statistics and settings used to hedge slow attempts of a task. Once
+/// enough runtimes were recorded, an attempt that takes longer than the given
+/// percentile of recent runtimes gets a duplicate launched on the executor.
+/// A policy can be shared by several tasks running the same kind of work
+class hedging_policy {
+public:
+
+    /// Constructs a policy launching attempts on the given executor. Hedging starts
+    /// once min_samples runtimes were recorded. Only the last `window` runtimes are kept.
+    /// The executor must outlive the policy and should not be the one running the task
+    explicit hedging_policy(transwarp::executor& executor,
+                            double percentile = 0.95,
+                            std::size_t min_samples = 20,
+                            std::size_t window = 100)
+    : executor_(executor),
+      percentile_(percentile),
+      min_samples_(min_samples),
+      samples_(window)
+    {
+        if (percentile <= 0 || percentile > 1) {
+            throw transwarp::invalid_parameter{"percentile"};
+        }
+        if (window == 0 || min_samples > window) {
+            throw transwarp::invalid_parameter{"window"};
+        }
+    }
+
+    // delete copy/move semantics
+    hedging_policy(const hedging_policy&) = delete;
+    hedging_policy& operator=(const hedging_policy&) = delete;
+    hedging_policy(hedging_policy&&) = delete;
+    hedging_policy& operator=(hedging_policy&&) = delete;
+
+    /// Returns the executor running attempts
+    transwarp::executor& executor() noexcept {
+        return executor_;
+    }
+
+    /// Returns the percentile of runtimes after which a duplicate is launched
+    double percentile() const noexcept {
+        return percentile_;
+    }
+
+    /// Records the runtime of a finished attempt
+    void add_sample(std::chrono::nanoseconds runtime) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        samples_[next_] = runtime;
+        next_ = (next_ + 1) % samples_.size();
+        if (count_ < samples_.size()) {
+            ++count_;
+        }
+    }
+
+    /// Returns the number of recorded runtimes
+    std::size_t sample_count() {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return count_;
+    }
+
+    /// Returns the runtime after which a duplicate is launched. Returns zero
+    /// while there are not enough samples, i.e. attempts are not hedged yet
+    std::chrono::nanoseconds threshold() {
+        std::vector<std::chrono::nanoseconds> samples;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (count_ < min_samples_ || count_ == 0) {
+                return std::chrono::nanoseconds{0};
+            }
+            samples.assign(samples_.begin(), samples_.begin() + static_cast<std::ptrdiff_t>(count_));
+        }
+        const auto index = static_cast<std::size_t>(percentile_ * static_cast<double>(samples.size() - 1) + 0.5);
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+        return std::max(samples[index], std::chrono::nanoseconds{1});
+    }
+
+    /// Returns the number of duplicates launched so far
+    std::size_t hedge_count() const noexcept {
+        return hedge_count_;
+    }
+
+private:
+    template<typename>
+    friend class transwarp::detail::hedged_functor;
+
+    transwarp::executor& executor_;
+    const double percentile_;
+    const std::size_t min_samples_;
+    std::mutex mutex_;
+    std::vector<std::chrono::nanoseconds> samples_;
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+    std::atomic<std::size_t> hedge_count_{0};
+};
+
+
+/// Detail namespace for internal functionality only
+namespace detail {
+
+/// The race between the attempts of a hedged call. The first attempt to finish wins
+template<typename Result>
+struct hedge_race {
+    std::promise<Result> promise;
+    std::atomic<bool> done{false};
+
+    template<typename Call>
+    bool run(Call& call) {
+        try {
+            Result result = call();
+            if (!done.exchange(true)) {
+                promise.set_value(std::move(result));
+                return true;
+            }
+        } catch (...) {
+            if (!done.exchange(true)) {
+                promise.set_exception(std::current_exception());
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template<>
+struct hedge_race<void> {
+    std::promise<void> promise;
+    std::atomic<bool> done{false};
+
+    template<typename Call>
+    bool run(Call& call) {
+        try {
+            call();
+            if (!done.exchange(true)) {
+                promise.set_value();
+                return true;
+            }
+        } catch (...) {
+            if (!done.exchange(true)) {
+                promise.set_exception(std::current_exception());
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// Invokes a shared functor. Used to bind copies of the arguments of a hedged call
+template<typename Functor>
+struct hedge_invoker {
+    std::shared_ptr<Functor> functor;
+
+    template<typename... Args>
+    auto operator()(Args&... args) -> decltype((*functor)(args...)) {
+        return (*functor)(args...);
+    }
+};
+
+/// Records the runtime of an inline call when going out of scope
+class hedge_sampler {
+public:
+
+    explicit hedge_sampler(transwarp::hedging_policy& policy)
+    : policy_(policy),
+      start_(std::chrono::steady_clock::now())
+    {}
+
+    ~hedge_sampler() {
+        policy_.add_sample(std::chrono::steady_clock::now() - start_);
+    }
+
+    // delete copy/move semantics
+    hedge_sampler(const hedge_sampler&) = delete;
+    hedge_sampler& operator=(const hedge_sampler&) = delete;
+    hedge_sampler(hedge_sampler&&) = delete;
+    hedge_sampler& operator=(hedge_sampler&&) = delete;
+
+private:
+    transwarp::hedging_policy& policy_;
+    const std::chrono::steady_clock::time_point start_;
+};
+
+/// The functor created by transwarp::hedged
+template<typename Functor>
+class hedged_functor : public transwarp::functor {
+public:
+
+    hedged_functor(std::shared_ptr<transwarp::hedging_policy> policy, Functor functor)
+    : policy_(std::move(policy)),
+      functor_(std::make_shared<Functor>(std::move(functor)))
+    {
+        if (!policy_) {
+            throw transwarp::invalid_parameter{"hedging policy pointer"};
+        }
+    }
+
+    template<typename... Args>
+    auto operator()(Args&&... args) -> typename std::decay<decltype(std::declval<Functor&>()(args...))>::type {
+        using result_t = typename std::decay<decltype(std::declval<Functor&>()(args...))>::type;
+        const std::chrono::nanoseconds threshold = policy_->threshold();
+        if (threshold.count() == 0) {
+            const transwarp::detail::hedge_sampler sampler{*policy_};
+            return (*functor_)(args...);
+        }
+        const auto race = std::make_shared<transwarp::detail::hedge_race<result_t>>();
+        const auto call = std::make_shared<std::function<result_t()>>(
+            std::bind(transwarp::detail::hedge_invoker<Functor>{functor_}, std::forward<Args>(args)...));
+        const std::shared_ptr<transwarp::hedging_policy> policy = policy_;
+        const std::function<void()> attempt = [race, call, policy] {
+            if (race->done) {
+                return; // lost before it started
+            }
+            const auto start = std::chrono::steady_clock::now();
+            if (race->run(*call)) {
+                policy->add_sample(std::chrono::steady_clock::now() - start);
+            }
+        };
+        std::future<result_t> future = race->promise.get_future();
+        policy_->executor().execute(attempt, transwarp_task());
+        if (future.wait_for(threshold) != std::future_status::ready && !race->done) {
+            ++policy_->hedge_count_;
+            policy_->executor().execute(attempt, transwarp_task());
+        }
+        return future.get();
+    }
+
+private:
+    std::shared_ptr<transwarp::hedging_policy> policy_;
+    std::shared_ptr<Functor> functor_;
+};
+
+} // detail
+
+
+/// Wraps an idempotent functor so that slow attempts are hedged according to the
+/// policy: an attempt that runs longer than the policy's runtime percentile gets a
+/// duplicate launched and the first attempt to finish provides the result. A loser
+/// that hasn't started yet is skipped, a running loser is left to finish.
+/// Attempts may run concurrently and share a copy of the arguments, so the functor
+/// must not modify its arguments. The result must be passed directly to make_task:
+/// ```
+/// auto task = tw::make_task(tw::consume, tw::hedged(policy, fetch), url);
+/// ```
+template<typename Functor>
+transwarp::detail::hedged_functor<typename std::decay<Functor>::type>
+hedged(std::shared_ptr<transwarp::hedging_policy> policy, Functor&& functor) {
+    return transwarp::detail::hedged_functor<typename std::decay<Functor>::type>{std::move(policy), std::forward<Functor>(functor)};
+}
+
+
 /// Detail namespace for internal functionality only
 namespace detail {
 
@@ -2255,14 +2962,7 @@ public:
             this->tasks_.reset(new typename transwarp::detail::task_common<result_type>::tasks_t);
             visit(transwarp::detail::final_visitor{*this->tasks_});
             unvisit();
-            auto compare = [](const transwarp::itask* const l, const transwarp::itask* const r) {
-                const std::size_t l_level = l->level();
-                const std::size_t l_id = l->id();
-                const std::size_t r_level = r->level();
-                const std::size_t r_id = r->id();
-                return std::tie(l_level, l_id) < std::tie(r_level, r_id);
-            };
-            std::sort(this->tasks_->begin(), this->tasks_->end(), compare);
+            transwarp::detail::sort_by_level(*this->tasks_);
         }
     }
 
@@ -3350,6 +4050,269 @@ const transwarp::task<Value>* cast(const transwarp::itask* task) {
 }
 
 
+/// A graph of tasks defined by one or more sink tasks. Scheduling the graph
+/// schedules the union of all the sinks' ancestors exactly once which avoids
+/// an artificial wait task or multiple schedule_all calls for graphs with
+/// several outputs that share parents
+class graph {
+public:
+
+    /// Constructs a graph from the given sink tasks
+    explicit graph(std::vector<std::shared_ptr<transwarp::itask>> sinks)
+    : sinks_(std::move(sinks))
+    {
+        if (sinks_.empty()) {
+            throw transwarp::invalid_parameter{"sinks"};
+        }
+        for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+            if (!sink) {
+                throw transwarp::invalid_parameter{"sink pointer"};
+            }
+        }
+    }
+
+    // delete copy/move semantics
+    graph(const graph&) = delete;
+    graph& operator=(const graph&) = delete;
+    graph(graph&&) = delete;
+    graph& operator=(graph&&) = delete;
+
+    /// Computes and caches the union of all tasks in the graph. This is done
+    /// implicitly when calling, e.g., any of the *_all methods. It should
+    /// normally not be necessary to call this method directly
+    void finalize() {
+        if (tasks_.empty()) {
+            transwarp::detail::final_visitor visitor{tasks_};
+            const std::function<void(transwarp::itask&)> collect = std::ref(visitor);
+            for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+                transwarp::detail::visit_visitor{collect}(*sink);
+            }
+            for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+                transwarp::detail::unvisit_visitor{}(*sink);
+            }
+            transwarp::detail::sort_by_level(tasks_);
+        }
+    }
+
+    /// Returns the sink tasks of this graph
+    const std::vector<std::shared_ptr<transwarp::itask>>& sinks() const noexcept {
+        return sinks_;
+    }
+
+    /// Returns all tasks in the graph in breadth order. Every task appears once
+    /// even if it is an ancestor of several sinks
+    const std::vector<transwarp::itask*>& tasks() {
+        finalize();
+        return tasks_;
+    }
+
+    /// Returns all edges in the graph
+    std::vector<transwarp::edge> edges() {
+        std::vector<transwarp::edge> edges;
+        transwarp::detail::edges_visitor visitor{edges};
+        visit_all(visitor);
+        return edges;
+    }
+
+    /// Schedules all tasks in the graph for execution on the caller thread.
+    /// The task-specific executors get precedence if they exist.
+    /// This overload will reset the underlying futures.
+    void schedule_all() {
+        ensure_graph_not_running();
+        schedule_all_impl(true);
+    }
+
+    /// Schedules all tasks in the graph for execution using the provided executor.
+    /// The task-specific executors get precedence if they exist.
+    /// This overload will reset the underlying futures.
+    void schedule_all(transwarp::executor& executor) {
+        ensure_graph_not_running();
+        schedule_all_impl(true, &executor);
+    }
+
+    /// Schedules all tasks in the graph for execution on the caller thread.
+    /// The task-specific executors get precedence if they exist.
+    /// reset_all denotes whether schedule_all should reset the underlying
+    /// futures and schedule even if the futures are already present.
+    void schedule_all(bool reset_all) {
+        ensure_graph_not_running();
+        schedule_all_impl(reset_all);
+    }
+
+    /// Schedules all tasks in the graph for execution using the provided executor.
+    /// The task-specific executors get precedence if they exist.
+    /// reset_all denotes whether schedule_all should reset the underlying
+    /// futures and schedule even if the futures are already present.
+    void schedule_all(transwarp::executor& executor, bool reset_all) {
+        ensure_graph_not_running();
+        schedule_all_impl(reset_all, &executor);
+    }
+
+    /// Schedules the given task and only those of its ancestors that do not
+    /// already have a valid future for execution on the caller thread.
+    /// Tasks outside of the given task's ancestry are not scheduled.
+    /// The task-specific executors get precedence if they exist.
+    /// Throws transwarp::invalid_parameter if the task is not part of the graph
+    void schedule_for(transwarp::itask& task) {
+        schedule_for_impl(task);
+    }
+
+    /// Schedules the given task and only those of its ancestors that do not
+    /// already have a valid future for execution using the provided executor.
+    /// Tasks outside of the given task's ancestry are not scheduled.
+    /// The task-specific executors get precedence if they exist.
+    /// Throws transwarp::invalid_parameter if the task is not part of the graph
+    void schedule_for(transwarp::executor& executor, transwarp::itask& task) {
+        schedule_for_impl(task, &executor);
+    }
+
+    /// Demand-driven retrieval of a task's result. Schedules what is needed to
+    /// compute the given task on the caller thread (see schedule_for) and
+    /// returns the task's result
+    template<typename Task>
+    auto get(const std::shared_ptr<Task>& task) -> typename transwarp::result<typename Task::result_type>::type {
+        ensure_task_pointer(task);
+        schedule_for_impl(*task);
+        return task->get();
+    }
+
+    /// Demand-driven retrieval of a task's result. Schedules what is needed to
+    /// compute the given task using the provided executor (see schedule_for),
+    /// waits for the task to finish, and returns the task's result
+    template<typename Task>
+    auto get(transwarp::executor& executor, const std::shared_ptr<Task>& task) -> typename transwarp::result<typename Task::result_type>::type {
+        ensure_task_pointer(task);
+        schedule_for_impl(*task, &executor);
+        return task->get();
+    }
+
+    /// Waits for all sinks to complete. Should only be called if the graph
+    /// was scheduled, throws transwarp::control_error otherwise
+    void wait() const {
+        for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+            sink->wait();
+        }
+    }
+
+    /// Returns whether all sinks have finished processing
+    bool is_ready() const {
+        for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+            if (!sink->is_ready()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Resets all tasks in the graph
+    void reset_all() {
+        ensure_graph_not_running();
+        transwarp::detail::reset_visitor visitor;
+        visit_all(visitor);
+    }
+
+    /// If enabled then all pending tasks in the graph are canceled which will
+    /// throw transwarp::task_canceled when retrieving the task result.
+    /// Passing false is equivalent to resume.
+    void cancel_all(bool enabled) noexcept {
+        transwarp::detail::cancel_visitor visitor{enabled};
+        visit_all(visitor);
+    }
+
+    /// Adds a new listener for all event types to all tasks in the graph
+    void add_listener_all(std::shared_ptr<transwarp::listener> listener) {
+        ensure_graph_not_running();
+        transwarp::detail::add_listener_visitor visitor{std::move(listener)};
+        visit_all(visitor);
+    }
+
+    /// Adds a new listener for the given event type to all tasks in the graph
+    void add_listener_all(transwarp::event_type event, std::shared_ptr<transwarp::listener> listener) {
+        ensure_graph_not_running();
+        transwarp::detail::add_listener_per_event_visitor visitor{event, std::move(listener)};
+        visit_all(visitor);
+    }
+
+    /// Removes the listener for all event types from all tasks in the graph
+    void remove_listener_all(const std::shared_ptr<transwarp::listener>& listener) {
+        ensure_graph_not_running();
+        transwarp::detail::remove_listener_visitor visitor{listener};
+        visit_all(visitor);
+    }
+
+    /// Removes the listener for the given event type from all tasks in the graph
+    void remove_listener_all(transwarp::event_type event, const std::shared_ptr<transwarp::listener>& listener) {
+        ensure_graph_not_running();
+        transwarp::detail::remove_listener_per_event_visitor visitor{event, listener};
+        visit_all(visitor);
+    }
+
+private:
+
+    /// Checks if any of the sinks is currently running and throws transwarp::control_error if so
+    void ensure_graph_not_running() const {
+        for (const std::shared_ptr<transwarp::itask>& sink : sinks_) {
+            if (sink->was_scheduled() && !sink->is_ready()) {
+                throw transwarp::control_error{"graph currently running: " + transwarp::to_string(*sink, " ")};
+            }
+        }
+    }
+
+    /// Schedules every task in the graph once using the provided executor
+    void schedule_all_impl(bool reset_all, transwarp::executor* executor=nullptr) {
+        transwarp::detail::schedule_visitor visitor{reset_all, executor};
+        visit_all(visitor);
+    }
+
+    /// Schedules the task's ancestors that are missing a future using the provided executor
+    void schedule_for_impl(transwarp::itask& task, transwarp::executor* executor=nullptr) {
+        transwarp::detail::schedule_visitor visitor{false, executor};
+        for (transwarp::itask* t : ancestors(task)) {
+            visitor(*t);
+        }
+    }
+
+    /// Returns the cached ancestors of the given task including the task itself in breadth order
+    const std::vector<transwarp::itask*>& ancestors(transwarp::itask& task) {
+        const auto ancestors_it = ancestors_.find(&task);
+        if (ancestors_it != ancestors_.end()) {
+            return ancestors_it->second;
+        }
+        finalize();
+        if (std::find(tasks_.begin(), tasks_.end(), &task) == tasks_.end()) {
+            throw transwarp::invalid_parameter{"task not part of graph"};
+        }
+        std::vector<transwarp::itask*> tasks;
+        transwarp::detail::push_task_visitor visitor{tasks};
+        const std::function<void(transwarp::itask&)> collect = std::ref(visitor);
+        transwarp::detail::visit_visitor{collect}(task);
+        transwarp::detail::unvisit_visitor{}(task);
+        transwarp::detail::sort_by_level(tasks);
+        return ancestors_.emplace(&task, std::move(tasks)).first->second;
+    }
+
+    /// Checks for a non-null task pointer
+    void ensure_task_pointer(const std::shared_ptr<transwarp::itask>& task) const {
+        if (!task) {
+            throw transwarp::invalid_parameter{"task pointer"};
+        }
+    }
+
+    /// Visits all tasks
+    template<typename Visitor>
+    void visit_all(Visitor& visitor) {
+        finalize();
+        for (transwarp::itask* t : tasks_) {
+            visitor(*t);
+        }
+    }
+
+    std::vector<std::shared_ptr<transwarp::itask>> sinks_;
+    std::vector<transwarp::itask*> tasks_;
+    std::unordered_map<const transwarp::itask*, std::vector<transwarp::itask*>> ancestors_;
+};
+
+
 /// A function similar to std::for_each but returning a transwarp task for
 /// deferred, possibly asynchronous execution. This function creates a graph
 /// with std::distance(first, last) root tasks
@@ -3741,4 +4704,138 @@ private:
 };
 
 
+/// A thread-safe pool of result buffers. A task's functor can acquire a buffer
+/// from the pool instead of allocating a fresh one on every run. Buffers are
+/// returned to the pool by the recycler listener once the task's result is released
+template<typename T>
+class result_pool {
+public:
+
+    /// Constructs a pool holding at most maximum_size buffers
+    explicit result_pool(std::size_t maximum_size = 64)
+    : maximum_(maximum_size)
+    {
+        if (maximum_ < 1) {
+            throw transwarp::invalid_parameter{"maximum size"};
+        }
+    }
+
+    // delete copy/move semantics
+    result_pool(const result_pool&) = delete;
+    result_pool& operator=(const result_pool&) = delete;
+    result_pool(result_pool&&) = delete;
+    result_pool& operator=(result_pool&&) = delete;
+
+    /// Returns a recycled buffer if there is one that is not referenced
+    /// anywhere else. Returns a new default-constructed buffer otherwise.
+    /// A recycled buffer keeps its previous contents and capacity
+    std::shared_ptr<T> acquire() {
+        {
+            std::lock_guard<transwarp::detail::spinlock> lock{spinlock_};
+            for (std::size_t i = 0; i < buffers_.size(); ++i) {
+                if (buffers_[i].use_count() == 1) {
+                    std::shared_ptr<T> buffer = std::move(buffers_[i]);
+                    buffers_[i] = std::move(buffers_.back());
+                    buffers_.pop_back();
+                    return buffer;
+                }
+            }
+        }
+        return std::make_shared<T>();
+    }
+
+    /// Returns the given buffer to the pool. The buffer is dropped if the pool is full
+    void release(std::shared_ptr<T> buffer) {
+        if (!buffer) {
+            return;
+        }
+        std::lock_guard<transwarp::detail::spinlock> lock{spinlock_};
+        if (buffers_.size() < maximum_) {
+            buffers_.push_back(std::move(buffer));
+        }
+    }
+
+    /// Returns the number of buffers currently held by the pool
+    std::size_t size() const {
+        std::lock_guard<transwarp::detail::spinlock> lock{spinlock_};
+        return buffers_.size();
+    }
+
+    /// Returns the maximum number of buffers held by the pool
+    std::size_t maximum_size() const noexcept {
+        return maximum_;
+    }
+
+    /// Drops all buffers
+    void clear() {
+        std::lock_guard<transwarp::detail::spinlock> lock{spinlock_};
+        buffers_.clear();
+    }
+
+private:
+    std::size_t maximum_;
+    mutable transwarp::detail::spinlock spinlock_; // protecting buffers_
+    std::vector<std::shared_ptr<T>> buffers_;
+};
+
+
+/// The recycler returns a task's result of type std::shared_ptr<T> to a result_pool
+/// when the result is released. Like the releaser, it releases a task's future when
+/// the task's `after_satisfied` event was received. In addition, the previous result
+/// is recycled just before a task is rescheduled. Tasks whose result type is not
+/// std::shared_ptr<T> are ignored so the recycler can be added to a whole graph
+template<typename T>
+class recycler : public transwarp::listener {
+public:
+
+    /// The pool that results are returned to
+    explicit recycler(std::shared_ptr<transwarp::result_pool<T>> pool)
+    : pool_(std::move(pool))
+    {
+        if (!pool_) {
+            throw transwarp::invalid_parameter{"pool pointer"};
+        }
+    }
+
+    // delete copy/move semantics
+    recycler(const recycler&) = delete;
+    recycler& operator=(const recycler&) = delete;
+    recycler(recycler&&) = delete;
+    recycler& operator=(recycler&&) = delete;
+
+    void handle_event(const transwarp::event_type event, transwarp::itask& task) override {
+        if (event == transwarp::event_type::before_scheduled) {
+            recycle(task, false);
+        } else if (event == transwarp::event_type::after_satisfied) {
+            recycle(task, true);
+        }
+    }
+
+private:
+
+    void recycle(transwarp::itask& task, bool release) {
+        auto t = dynamic_cast<transwarp::task<std::shared_ptr<T>>*>(&task);
+        if (!t) {
+            return;
+        }
+        const std::shared_future<std::shared_ptr<T>> future = t->future();
+        if (!future.valid() || future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            return;
+        }
+        std::shared_ptr<T> buffer;
+        try {
+            buffer = future.get();
+        } catch (...) {
+            // nothing to recycle
+        }
+        if (release) {
+            task.reset_future();
+        }
+        pool_->release(std::move(buffer));
+    }
+
+    std::shared_ptr<transwarp::result_pool<T>> pool_;
+};
+
+
 } // transwarp
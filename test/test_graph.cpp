@@ -0,0 +1,149 @@
+#include "test.h"
+
+TEST_CASE("graph_with_no_sinks") {
+    REQUIRE_THROWS_AS(tw::graph{{}}, tw::invalid_parameter);
+}
+
+TEST_CASE("graph_with_null_sink") {
+    std::vector<std::shared_ptr<tw::itask>> sinks = {nullptr};
+    REQUIRE_THROWS_AS(tw::graph{sinks}, tw::invalid_parameter);
+}
+
+TEST_CASE("graph_tasks_are_the_union_of_all_ancestors") {
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto t2 = tw::make_task(tw::root, []{ return 2; });
+    auto s1 = tw::make_task(tw::consume, [](int a, int b){ return a + b; }, t1, t2);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a * 10; }, t2);
+    tw::graph g{{s1, s2}};
+    REQUIRE(4u == g.tasks().size());
+    REQUIRE(2u == g.sinks().size());
+    REQUIRE(3u == g.edges().size());
+    std::vector<std::size_t> ids;
+    for (const tw::itask* t : g.tasks()) {
+        ids.push_back(t->id());
+    }
+    std::sort(ids.begin(), ids.end());
+    REQUIRE((std::vector<std::size_t>{0, 1, 2, 3}) == ids);
+}
+
+TEST_CASE("graph_schedules_shared_parents_exactly_once") {
+    std::atomic<int> count1{0};
+    std::atomic<int> count2{0};
+    auto t1 = tw::make_task(tw::root, [&count1]{ ++count1; return 1; });
+    auto t2 = tw::make_task(tw::root, [&count2]{ ++count2; return 2; });
+    auto s1 = tw::make_task(tw::consume, [](int a, int b){ return a + b; }, t1, t2);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a * 10; }, t2);
+    tw::graph g{{s1, s2}};
+    g.schedule_all();
+    REQUIRE(3 == s1->get());
+    REQUIRE(20 == s2->get());
+    REQUIRE(1 == count1);
+    REQUIRE(1 == count2);
+    tw::parallel exec{2};
+    g.schedule_all(exec);
+    g.wait();
+    REQUIRE(g.is_ready());
+    REQUIRE(3 == s1->get());
+    REQUIRE(20 == s2->get());
+    REQUIRE(2 == count1);
+    REQUIRE(2 == count2);
+}
+
+TEST_CASE("graph_schedule_all_without_reset") {
+    std::atomic<int> count{0};
+    auto t1 = tw::make_task(tw::root, [&count]{ ++count; return 1; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 1; }, t1);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a + 2; }, t1);
+    tw::graph g{{s1, s2}};
+    g.schedule_all();
+    tw::sequential exec;
+    g.schedule_all(exec, false);
+    REQUIRE(1 == count);
+    g.reset_all();
+    REQUIRE_FALSE(s1->was_scheduled());
+    g.schedule_all(false);
+    REQUIRE(2 == count);
+    REQUIRE(3 == s2->get());
+}
+
+TEST_CASE("graph_cancel_all") {
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 1; }, t1);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a + 2; }, t1);
+    tw::graph g{{s1, s2}};
+    g.cancel_all(true);
+    g.schedule_all(false);
+    REQUIRE_THROWS_AS(s1->get(), tw::task_canceled);
+    REQUIRE_THROWS_AS(s2->get(), tw::task_canceled);
+    g.cancel_all(false);
+    g.schedule_all();
+    REQUIRE(2 == s1->get());
+}
+
+struct graph_count_listener : tw::listener {
+    std::atomic<int> count{0};
+    void handle_event(tw::event_type, tw::itask&) override {
+        ++count;
+    }
+};
+
+TEST_CASE("graph_add_and_remove_listener_all") {
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 1; }, t1);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a + 2; }, t1);
+    tw::graph g{{s1, s2}};
+    auto l = std::make_shared<graph_count_listener>();
+    g.add_listener_all(tw::event_type::after_finished, l);
+    g.schedule_all();
+    REQUIRE(3 == l->count);
+    g.remove_listener_all(tw::event_type::after_finished, l);
+    g.schedule_all();
+    REQUIRE(3 == l->count);
+}
+
+TEST_CASE("graph_schedule_for_only_schedules_ancestors") {
+    std::atomic<int> count1{0};
+    std::atomic<int> count2{0};
+    auto t1 = tw::make_task(tw::root, [&count1]{ ++count1; return 1; });
+    auto t2 = tw::make_task(tw::root, [&count2]{ ++count2; return 2; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 10; }, t1);
+    auto s2 = tw::make_task(tw::consume, [](int a, int b){ return a + b; }, t1, t2);
+    tw::graph g{{s1, s2}};
+    g.schedule_for(*s1);
+    REQUIRE(11 == s1->get());
+    REQUIRE(1 == count1);
+    REQUIRE(0 == count2);
+    REQUIRE_FALSE(s2->was_scheduled());
+    REQUIRE(3 == g.get(s2)); // t1 already has a result
+    REQUIRE(1 == count1);
+    REQUIRE(1 == count2);
+    REQUIRE(3 == g.get(s2)); // nothing to be done
+    REQUIRE(1 == count1);
+    REQUIRE(1 == count2);
+}
+
+TEST_CASE("graph_get_with_executor") {
+    std::atomic<int> count{0};
+    auto t1 = tw::make_task(tw::root, [&count]{ ++count; return 1; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 10; }, t1);
+    auto s2 = tw::make_task(tw::consume, [](int a){ return a + 20; }, t1);
+    tw::graph g{{s1, s2}};
+    tw::parallel exec{2};
+    REQUIRE(21 == g.get(exec, s2));
+    REQUIRE_FALSE(s1->was_scheduled());
+    t1->reset();
+    g.schedule_for(exec, *s1);
+    REQUIRE(11 == s1->get());
+    REQUIRE(2 == count);
+}
+
+TEST_CASE("graph_schedule_for_with_task_outside_of_graph") {
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto s1 = tw::make_task(tw::consume, [](int a){ return a + 10; }, t1);
+    auto other = tw::make_task(tw::root, []{ return 2; });
+    tw::graph g{{s1}};
+    REQUIRE_THROWS_AS(g.schedule_for(*other), tw::invalid_parameter);
+    REQUIRE_THROWS_AS(g.get(other), tw::invalid_parameter);
+    std::shared_ptr<tw::task<int>> null_task;
+    REQUIRE_THROWS_AS(g.get(null_task), tw::invalid_parameter);
+}
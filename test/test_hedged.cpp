@@ -0,0 +1,89 @@
+#include "test.h"
+
+TEST_CASE("hedging_policy_with_invalid_parameters") {
+    tw::sequential exec;
+    REQUIRE_THROWS_AS(tw::hedging_policy(exec, 0.), tw::invalid_parameter);
+    REQUIRE_THROWS_AS(tw::hedging_policy(exec, 1.5), tw::invalid_parameter);
+    REQUIRE_THROWS_AS(tw::hedging_policy(exec, 0.9, 10, 0), tw::invalid_parameter);
+    REQUIRE_THROWS_AS(tw::hedging_policy(exec, 0.9, 10, 5), tw::invalid_parameter);
+}
+
+TEST_CASE("hedging_policy_threshold") {
+    tw::sequential exec;
+    tw::hedging_policy policy{exec, 0.5, 3, 4};
+    REQUIRE(0.5 == policy.percentile());
+    policy.add_sample(std::chrono::nanoseconds{10});
+    policy.add_sample(std::chrono::nanoseconds{30});
+    REQUIRE(0 == policy.threshold().count());
+    policy.add_sample(std::chrono::nanoseconds{20});
+    REQUIRE(3u == policy.sample_count());
+    REQUIRE(20 == policy.threshold().count());
+    policy.add_sample(std::chrono::nanoseconds{40});
+    policy.add_sample(std::chrono::nanoseconds{50}); // drops 10
+    REQUIRE(4u == policy.sample_count());
+    REQUIRE(40 == policy.threshold().count());
+}
+
+TEST_CASE("hedged_with_null_policy") {
+    REQUIRE_THROWS_AS(tw::hedged(nullptr, []{ return 1; }), tw::invalid_parameter);
+}
+
+TEST_CASE("hedged_runs_inline_without_samples") {
+    tw::parallel exec{2};
+    auto policy = std::make_shared<tw::hedging_policy>(exec, 0.95, 3, 10);
+    const auto id = std::this_thread::get_id();
+    auto task = tw::make_task(tw::root, tw::hedged(policy, [id]{
+        return std::this_thread::get_id() == id;
+    }));
+    task->schedule();
+    REQUIRE(task->get());
+    REQUIRE(1u == policy->sample_count());
+    REQUIRE(0u == policy->hedge_count());
+}
+
+TEST_CASE("hedged_launches_duplicate_for_slow_attempt") {
+    tw::parallel exec{2};
+    auto policy = std::make_shared<tw::hedging_policy>(exec, 0.95, 2, 10);
+    std::atomic<int> calls{0};
+    auto parent = tw::make_task(tw::root, []{ return 21; });
+    auto task = tw::make_task(tw::consume, tw::hedged(policy, [&calls](int x){
+        if (++calls == 3) { // first hedged attempt is slow
+            std::this_thread::sleep_for(std::chrono::milliseconds{200});
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        return 2 * x;
+    }), parent);
+    task->schedule_all();
+    task->schedule_all();
+    REQUIRE(2u == policy->sample_count());
+    REQUIRE(0u == policy->hedge_count());
+    task->schedule_all();
+    REQUIRE(42 == task->get());
+    REQUIRE(1u == policy->hedge_count());
+    REQUIRE(4 == calls);
+}
+
+TEST_CASE("hedged_fast_attempt_is_not_duplicated") {
+    tw::parallel exec{2};
+    auto policy = std::make_shared<tw::hedging_policy>(exec, 1., 1, 10);
+    policy->add_sample(std::chrono::seconds{10});
+    std::atomic<int> calls{0};
+    auto task = tw::make_task(tw::root, tw::hedged(policy, [&calls]{ ++calls; }));
+    task->schedule();
+    task->get();
+    REQUIRE(1 == calls);
+    REQUIRE(0u == policy->hedge_count());
+    REQUIRE(2u == policy->sample_count());
+}
+
+TEST_CASE("hedged_rethrows_exception_of_first_attempt") {
+    tw::parallel exec{2};
+    auto policy = std::make_shared<tw::hedging_policy>(exec, 1., 1, 10);
+    policy->add_sample(std::chrono::seconds{10});
+    auto task = tw::make_task(tw::root, tw::hedged(policy, []() -> int {
+        throw std::runtime_error{"error"};
+    }));
+    task->schedule();
+    REQUIRE_THROWS_AS(task->get(), std::runtime_error);
+}
@@ -0,0 +1,116 @@
+#include "test.h"
+#include <numeric>
+
+TEST_CASE("memory_budget_name_and_budget") {
+    tw::sequential exec;
+    tw::memory_budget budget{exec, 100};
+    REQUIRE("transwarp::memory_budget" == budget.name());
+    REQUIRE(100u == budget.budget());
+    REQUIRE(0u == budget.live_bytes());
+}
+
+struct live_counter : tw::listener {
+    explicit live_counter(std::atomic<std::size_t>& live)
+    : live(live)
+    {}
+    void handle_event(tw::event_type, tw::itask& task) override {
+        if (task.level() == 0) {
+            --live;
+        }
+    }
+    std::atomic<std::size_t>& live;
+};
+
+TEST_CASE("memory_budget_bounds_live_results") {
+    const std::size_t n = 8;
+    tw::parallel exec{4};
+    auto budget = std::make_shared<tw::memory_budget>(exec, 250);
+    std::atomic<std::size_t> live{0};
+    std::atomic<std::size_t> max_live{0};
+    std::vector<std::shared_ptr<tw::task<int>>> consumers;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto producer = tw::make_task(tw::root, [&live, &max_live]{
+            const std::size_t now = ++live;
+            std::size_t max = max_live;
+            while (now > max && !max_live.compare_exchange_weak(max, now));
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            return 1;
+        });
+        budget->set_result_size(*producer, 100);
+        auto consumer = tw::make_task(tw::consume, [](int x){ return x; }, producer);
+        consumers.push_back(consumer);
+    }
+    auto sink = tw::make_task(tw::consume, [](const std::vector<int>& xs){
+        return std::accumulate(xs.begin(), xs.end(), 0);
+    }, consumers);
+    sink->add_listener_all(tw::event_type::after_satisfied, std::make_shared<live_counter>(live));
+    sink->add_listener_all(tw::event_type::after_satisfied, budget);
+    sink->schedule_all(*budget);
+    REQUIRE(static_cast<int>(n) == sink->get());
+    REQUIRE(max_live <= 2u);
+    REQUIRE(0u == budget->live_bytes());
+}
+
+TEST_CASE("memory_budget_admits_oversized_task_when_idle") {
+    tw::parallel exec{2};
+    auto budget = std::make_shared<tw::memory_budget>(exec, 10);
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto t2 = tw::make_task(tw::root, []{ return 2; });
+    auto sink = tw::make_task(tw::consume, [](int a, int b){ return a + b; }, t1, t2);
+    budget->set_result_size(*t1, 100);
+    budget->set_result_size(*t2, 100);
+    sink->add_listener_all(budget);
+    sink->schedule_all(*budget);
+    REQUIRE(3 == sink->get());
+    REQUIRE(0u == budget->live_bytes());
+    sink->schedule_all(*budget);
+    REQUIRE(3 == sink->get());
+}
+
+TEST_CASE("memory_budget_sink_result_stays_live_until_rerun") {
+    tw::sequential exec;
+    auto budget = std::make_shared<tw::memory_budget>(exec, 1000);
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto sink = tw::make_task(tw::consume, [](int a){ return a + 1; }, t1);
+    budget->set_result_size(*t1, 10);
+    budget->set_result_size(*sink, 20);
+    sink->add_listener_all(budget);
+    sink->schedule_all(*budget);
+    REQUIRE(2 == sink->get());
+    REQUIRE(20u == budget->live_bytes());
+    sink->schedule_all(*budget);
+    REQUIRE(20u == budget->live_bytes());
+}
+
+TEST_CASE("memory_budget_reported_size_from_within_functor") {
+    tw::sequential exec;
+    auto budget = std::make_shared<tw::memory_budget>(exec, 1000);
+    std::shared_ptr<tw::task<std::vector<char>>> t1;
+    t1 = tw::make_task(tw::root, [&budget, &t1]{
+        std::vector<char> data(42);
+        budget->set_result_size(*t1, data.size());
+        return data;
+    });
+    auto sink = tw::make_task(tw::consume, [](const std::vector<char>& d){ return d.size(); }, t1);
+    sink->add_listener(budget);
+    t1->add_listener(tw::event_type::after_satisfied, budget);
+    sink->schedule_all(*budget);
+    REQUIRE(42u == sink->get());
+    REQUIRE(0u == budget->live_bytes());
+}
+
+TEST_CASE("memory_budget_with_wait_any") {
+    tw::parallel exec{2};
+    auto budget = std::make_shared<tw::memory_budget>(exec, 1000);
+    std::atomic_bool done{false};
+    auto t1 = tw::make_task(tw::root, []{ return 1; });
+    auto t2 = tw::make_task(tw::root, [&done]{
+        while (!done) std::this_thread::yield();
+        return 2;
+    });
+    auto sink = tw::make_task(tw::wait_any, []{ return 3; }, t1, t2);
+    sink->schedule_all(*budget);
+    REQUIRE(3 == sink->get());
+    done = true;
+    t2->wait();
+}
@@ -0,0 +1,89 @@
+#include "test.h"
+#include <numeric>
+
+using buffer_t = std::vector<double>;
+
+TEST_CASE("result_pool_with_invalid_maximum_size") {
+    REQUIRE_THROWS_AS(tw::result_pool<buffer_t>{0}, tw::invalid_parameter);
+}
+
+TEST_CASE("result_pool_acquire_and_release") {
+    tw::result_pool<buffer_t> pool{2};
+    REQUIRE(2u == pool.maximum_size());
+    auto b1 = pool.acquire();
+    REQUIRE(b1);
+    b1->resize(100);
+    const double* data = b1->data();
+    pool.release(b1);
+    REQUIRE(1u == pool.size());
+    auto b2 = pool.acquire(); // b1 still in use
+    REQUIRE(b2 != b1);
+    REQUIRE(1u == pool.size());
+    b1.reset();
+    auto b3 = pool.acquire();
+    REQUIRE(data == b3->data());
+    REQUIRE(0u == pool.size());
+    pool.release(b2);
+    pool.release(b3);
+    pool.release(std::make_shared<buffer_t>()); // pool is full
+    pool.release(nullptr);
+    REQUIRE(2u == pool.size());
+    pool.clear();
+    REQUIRE(0u == pool.size());
+}
+
+TEST_CASE("recycler_with_null_pool") {
+    REQUIRE_THROWS_AS(tw::recycler<buffer_t>{nullptr}, tw::invalid_parameter);
+}
+
+TEST_CASE("recycler_recycles_result_on_reschedule") {
+    auto pool = std::make_shared<tw::result_pool<buffer_t>>();
+    auto task = tw::make_task(tw::root, [pool]{
+        auto buffer = pool->acquire();
+        buffer->assign(1000, 42.);
+        return buffer;
+    });
+    task->add_listener(std::make_shared<tw::recycler<buffer_t>>(pool));
+    task->schedule();
+    const double* data = task->get()->data();
+    for (int i = 0; i < 5; ++i) {
+        task->schedule();
+        REQUIRE(data == task->get()->data());
+        REQUIRE(42. == task->get()->back());
+    }
+}
+
+TEST_CASE("recycler_recycles_result_once_satisfied") {
+    auto pool = std::make_shared<tw::result_pool<buffer_t>>();
+    auto parent = tw::make_task(tw::root, [pool]{
+        auto buffer = pool->acquire();
+        buffer->assign(10, 1.);
+        return buffer;
+    });
+    auto child = tw::make_task(tw::consume, [](const std::shared_ptr<buffer_t>& b){
+        return std::accumulate(b->begin(), b->end(), 0.);
+    }, parent);
+    auto int_task = tw::make_task(tw::root, []{ return 1; });
+    auto sink = tw::make_task(tw::consume, [](double x, int y){ return x + y; }, child, int_task);
+    sink->add_listener_all(std::make_shared<tw::recycler<buffer_t>>(pool));
+    tw::parallel exec{2};
+    sink->schedule_all(exec);
+    REQUIRE(11. == sink->get());
+    REQUIRE_FALSE(parent->was_scheduled());
+    REQUIRE(1u == pool->size());
+    sink->schedule_all(exec);
+    REQUIRE(11. == sink->get());
+    REQUIRE(1u == pool->size());
+}
+
+TEST_CASE("recycler_ignores_exceptions") {
+    auto pool = std::make_shared<tw::result_pool<buffer_t>>();
+    auto task = tw::make_task(tw::root, []() -> std::shared_ptr<buffer_t> {
+        throw std::runtime_error{"error"};
+    });
+    task->add_listener(std::make_shared<tw::recycler<buffer_t>>(pool));
+    task->schedule();
+    task->schedule();
+    REQUIRE_THROWS_AS(task->get(), std::runtime_error);
+    REQUIRE(0u == pool->size());
+}
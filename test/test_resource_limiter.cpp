@@ -0,0 +1,119 @@
+#include "test.h"
+
+TEST_CASE("resource_limiter_add_resource") {
+    tw::sequential exec;
+    tw::resource_limiter limiter{exec};
+    REQUIRE("transwarp::resource_limiter" == limiter.name());
+    REQUIRE_THROWS_AS(limiter.add_resource("db", 0), tw::invalid_parameter);
+    const std::size_t db = limiter.add_resource("db", 3);
+    REQUIRE("db" == limiter.resource_name(db));
+    REQUIRE(3u == limiter.capacity(db));
+    REQUIRE(3u == limiter.available(db));
+    REQUIRE_THROWS_AS(limiter.available(db + 1), tw::invalid_parameter);
+}
+
+TEST_CASE("resource_limiter_require_with_invalid_tokens") {
+    tw::sequential exec;
+    tw::resource_limiter limiter{exec};
+    const std::size_t db = limiter.add_resource("db", 2);
+    auto task = tw::make_task(tw::root, []{});
+    REQUIRE_THROWS_AS(limiter.require(*task, db, 3), tw::invalid_parameter);
+    REQUIRE_THROWS_AS(limiter.require(*task, db + 1, 1), tw::invalid_parameter);
+}
+
+TEST_CASE("resource_limiter_bounds_concurrent_use") {
+    tw::parallel exec{4};
+    tw::resource_limiter limiter{exec};
+    const std::size_t db = limiter.add_resource("db", 2);
+    std::atomic<int> in_use{0};
+    std::atomic<int> max_in_use{0};
+    std::vector<std::shared_ptr<tw::task<int>>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        auto task = tw::make_task(tw::root, [&in_use, &max_in_use]{
+            const int now = ++in_use;
+            int max = max_in_use;
+            while (now > max && !max_in_use.compare_exchange_weak(max, now));
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+            --in_use;
+            return 1;
+        });
+        limiter.require(*task, db, 1);
+        tasks.push_back(task);
+    }
+    auto sink = tw::make_task(tw::consume, [](const std::vector<int>& xs){
+        return static_cast<int>(xs.size());
+    }, tasks);
+    sink->schedule_all(limiter);
+    REQUIRE(8 == sink->get());
+    REQUIRE(max_in_use <= 2);
+    REQUIRE(2u == limiter.available(db));
+}
+
+TEST_CASE("resource_limiter_acquires_all_tokens_at_once") {
+    tw::parallel exec{4};
+    tw::resource_limiter limiter{exec};
+    const std::size_t a = limiter.add_resource("a", 1);
+    const std::size_t b = limiter.add_resource("b", 1);
+    std::atomic<int> in_use{0};
+    std::atomic<bool> overlap{false};
+    auto functor = [&in_use, &overlap]{
+        if (++in_use > 1) {
+            overlap = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        --in_use;
+    };
+    std::vector<std::shared_ptr<tw::task<void>>> tasks;
+    for (int i = 0; i < 6; ++i) {
+        auto task = tw::make_task(tw::root, functor);
+        if (i % 2 == 0) {
+            limiter.require(*task, a, 1);
+            limiter.require(*task, b, 1);
+        } else {
+            limiter.require(*task, b, 1);
+            limiter.require(*task, a, 1);
+        }
+        tasks.push_back(task);
+    }
+    auto sink = tw::make_task(tw::wait, []{}, tasks);
+    sink->schedule_all(limiter);
+    sink->get();
+    REQUIRE_FALSE(overlap);
+    REQUIRE(1u == limiter.available(a));
+    REQUIRE(1u == limiter.available(b));
+}
+
+TEST_CASE("resource_limiter_remove_requirement") {
+    tw::sequential exec;
+    tw::resource_limiter limiter{exec};
+    const std::size_t db = limiter.add_resource("db", 1);
+    std::size_t available = 0;
+    auto task = tw::make_task(tw::root, [&limiter, &available, db]{
+        available = limiter.available(db);
+    });
+    limiter.require(*task, db, 1);
+    task->schedule(limiter);
+    task->get();
+    REQUIRE(0u == available);
+    limiter.require(*task, db, 0);
+    task->schedule(limiter);
+    task->get();
+    REQUIRE(1u == available);
+}
+
+TEST_CASE("resource_limiter_releases_tokens_on_exception") {
+    tw::sequential exec;
+    tw::resource_limiter limiter{exec};
+    const std::size_t db = limiter.add_resource("db", 1);
+    auto task = tw::make_task(tw::root, []() -> int {
+        throw std::runtime_error{"error"};
+    });
+    limiter.require(*task, db, 1);
+    task->schedule(limiter);
+    REQUIRE_THROWS_AS(task->get(), std::runtime_error);
+    REQUIRE(1u == limiter.available(db));
+    auto child = tw::make_task(tw::consume, [](int x){ return x; }, task);
+    child->schedule_all(limiter);
+    REQUIRE_THROWS_AS(child->get(), std::runtime_error);
+    REQUIRE(1u == limiter.available(db));
+}